@@ -19,6 +19,9 @@ print_usage() {
     for cam in "${!CAMERAS[@]}"; do
         echo "  $cam"
     done
+    echo "  main10 (generated locally with libx265)"
+    echo "  resolution_switch (generated locally, checks the scaler cache and exits)"
+    echo "  alloc_check (builds with -DRTSP_ALLOC_TRACKING, checks steady-state allocations and exits)"
     echo ""
     echo "Options:"
     echo "  --no-resize         Disable frame resizing"
@@ -29,8 +32,13 @@ print_usage() {
     echo ""
     echo "Examples:"
     echo "  $0 burak_high                    # Use BGR format (default)"
+    echo "  $0 burak --main-record=/tmp/event.mp4 # Substream analyzed, main stream on trigger"
     echo "  $0 burak_high --color-format=bgr # Explicitly use BGR format"
     echo "  $0 burak_high --color-format=original # Use original color format"
+    echo "  $0 main10 --dither               # Local HEVC Main10 clip, 10-bit path"
+    echo "  $0 resolution_switch             # Mid-stream resolution change self-check"
+    echo "  $0 alloc_check                   # No per-frame allocations with a consumer attached"
+    echo "  $0 burak_high --rotate=90        # Camera mounted sideways"
 }
 
 # Check if any arguments are provided
@@ -43,8 +51,74 @@ fi
 CAMERA=$1
 shift  # Remove the first argument
 
+# Self-check: a clip that switches 640x360 -> 1280x720 -> 640x360 must
+# report two resolution changes and one scaler cache miss per geometry,
+# with every other frame's lookup a hit
+if [[ "$CAMERA" == "resolution_switch" ]]; then
+    CLIP="/tmp/resolution_switch.ts"
+    rm -f "$CLIP"
+    OFFSET=0
+    for SIZE in 640x360 1280x720 640x360; do
+        ffmpeg -loglevel error -y -f lavfi -i testsrc2=size=$SIZE:rate=25 -t 2 -c:v libx264 -pix_fmt yuv420p \
+            -output_ts_offset $OFFSET -f mpegts - >> "$CLIP" || exit 1
+        OFFSET=$((OFFSET + 2))
+    done
+    OUTPUT=$(./rtsp_player "$CLIP" --color-format=nv12 --no-record "$@" 2>&1) || { echo "$OUTPUT"; exit 1; }
+    FRAMES=$(sed -n 's/^Total frames processed: \([0-9]*\).*/\1/p' <<< "$OUTPUT")
+    read -r CHANGES HITS MISSES < <(sed -n \
+        's#^Resolution changes: \([0-9]*\), scaler cache hits/misses: \([0-9]*\)/\([0-9]*\).*#\1 \2 \3#p' <<< "$OUTPUT")
+    echo "Frames: $FRAMES, resolution changes: $CHANGES, scaler cache hits/misses: $HITS/$MISSES"
+    if [[ "$FRAMES" -gt 0 && "$CHANGES" == 2 && "$MISSES" == 2 && $((HITS + MISSES)) == "$FRAMES" ]]; then
+        echo "PASS"
+        exit 0
+    fi
+    echo "FAIL: expected 2 resolution changes, 2 misses and one scaler lookup per frame"
+    exit 1
+fi
+
+# Self-check: with a consumer keeping the latest frame, the conversion,
+# consumer and stats stages must not allocate once warmed up
+# (--alloc-check exits with 1 otherwise)
+if [[ "$CAMERA" == "alloc_check" ]]; then
+    CLIP="/tmp/alloc_check.mp4"
+    BINARY="/tmp/rtsp_player_alloc"
+    if [[ ! -f "$CLIP" ]]; then
+        ffmpeg -loglevel error -y -f lavfi -i testsrc2=size=1280x720:rate=25 -t 12 -c:v libx264 \
+            -pix_fmt yuv420p "$CLIP" || exit 1
+    fi
+    g++ -O2 -DRTSP_ALLOC_TRACKING rtsp_player.cpp -o "$BINARY" \
+        `pkg-config --cflags --libs opencv4 libavformat libavcodec libavutil libswscale libavfilter` \
+        -lrockchip_mpp -ljpeg || exit 1
+    STATUS=0
+    for FORMAT in bgr nv12; do
+        echo "--color-format=$FORMAT --consumer=view:"
+        "$BINARY" "$CLIP" --color-format=$FORMAT --consumer=view --no-record --alloc-check "$@" | \
+            grep "^Allocations per frame" || STATUS=1
+        [[ ${PIPESTATUS[0]} -eq 0 ]] || STATUS=1
+    done
+    [[ $STATUS -eq 0 ]] && echo "PASS" || echo "FAIL"
+    exit $STATUS
+fi
+
+# Locally generated HEVC Main10 test clip (no 10-bit camera needed)
+if [[ "$CAMERA" == "main10" ]]; then
+    CLIP="/tmp/main10.mp4"
+    if [[ ! -f "$CLIP" ]]; then
+        echo "Generating $CLIP..."
+        ffmpeg -y -f lavfi -i testsrc2=size=1920x1080:rate=30 -t 10 \
+            -c:v libx265 -pix_fmt yuv420p10le -x265-params log-level=error "$CLIP" || exit 1
+    fi
+    CAMERAS[main10]="$CLIP"
+fi
+
 # Check if the camera name exists in our map
-if [[ -n "${CAMERAS[$CAMERA]}" ]]; then
+if [[ -n "${CAMERAS[${CAMERA}_low]}" && -n "${CAMERAS[${CAMERA}_high]}" ]]; then
+    # Both streams of a camera: analyze the substream, main stream on demand
+    RTSP_URL="${CAMERAS[${CAMERA}_low]}"
+    set -- "--main-stream=${CAMERAS[${CAMERA}_high]}" "$@"
+    echo "Using camera pair: ${CAMERA}_low with ${CAMERA}_high on demand"
+    echo "RTSP URL: $RTSP_URL"
+elif [[ -n "${CAMERAS[$CAMERA]}" ]]; then
     # Use the mapped RTSP URL
     RTSP_URL="${CAMERAS[$CAMERA]}"
     echo "Using camera: $CAMERA"
@@ -61,7 +135,7 @@ OUTPUT_FILE="/tmp/output.mp4"
 # Build the command with all arguments
 CMD="./rtsp_player \"$RTSP_URL\""
 for arg in "$@"; do
-    if [[ "$arg" == *.mp4 ]]; then
+    if [[ "$arg" == *.mp4 && "$arg" != --* ]]; then
         OUTPUT_FILE="$arg"
     else
         CMD="$CMD \"$arg\""